@@ -20,6 +20,15 @@ bool BarcodeChecker::isValid(const char *barcodeText, BarcodeType type, bool _pa
   if (type == BarcodeType::Unknown) {
     return detectType(barcodeText, _padWithLeadingZeros) != BarcodeType::Unknown;
   }
+  else if (isAddOn(type)) {
+    char newBarcodeText[MAX_BARCODE_LENGTH + 1];
+    if (_padWithLeadingZeros) {
+      padWithLeadingZeros(newBarcodeText, barcodeText, type);
+      barcodeText = newBarcodeText;
+    }
+
+    return detectAddOnType(barcodeText, false) == type;
+  }
   else {
     if (_padWithLeadingZeros) {
       char newBarcodeText[MAX_BARCODE_LENGTH + 1];
@@ -57,11 +66,8 @@ BarcodeType BarcodeChecker::detectType(uint64_t codeNumber, bool padWithLeadingZ
 BarcodeType BarcodeChecker::detectType(const char *barcodeText, bool _padWithLeadingZeros) {
   // check if every character is a digit
   int textLength = strnlen(barcodeText, 20);
-  for (int i = 0; i < textLength; i++) {
-    int digit = barcodeText[i] - '0';
-    if (digit < 0 || digit > 9) {
-      return BarcodeType::Unknown;
-    }
+  if (!hasOnlyDigits(barcodeText, textLength)) {
+    return BarcodeType::Unknown;
   }
 
   // check text size
@@ -99,6 +105,61 @@ BarcodeType BarcodeChecker::detectType(const char *barcodeText, bool _padWithLea
   }
 }
 
+/////////////////////////////////////////////////
+// add-on methods
+/////////////////////////////////////////////////
+
+BarcodeType BarcodeChecker::detectAddOnType(const String &addOnText, bool padWithLeadingZeros) {
+  return detectAddOnType(addOnText.c_str(), padWithLeadingZeros);
+}
+
+BarcodeType BarcodeChecker::detectAddOnType(const char *addOnText, bool _padWithLeadingZeros) {
+  if (addOnText == nullptr) {
+    return BarcodeType::Unknown;
+  }
+
+  int textLength = strnlen(addOnText, MAX_BARCODE_LENGTH);
+  if (textLength == 0 || !hasOnlyDigits(addOnText, textLength)) {
+    return BarcodeType::Unknown;
+  }
+
+  if (textLength == 2) {
+    return BarcodeType::EAN2;
+  }
+  else if (textLength == 5) {
+    return BarcodeType::EAN5;
+  }
+  else if (_padWithLeadingZeros && textLength < 5) {
+    return (textLength < 2) ? BarcodeType::EAN2 : BarcodeType::EAN5;
+  }
+  else {
+    return BarcodeType::Unknown;
+  }
+}
+
+bool BarcodeChecker::isAddOn(BarcodeType type) {
+  return type == BarcodeType::EAN2 || type == BarcodeType::EAN5;
+}
+
+uint8_t BarcodeChecker::getAddOnChecksum(const char *addOnText, BarcodeType type) {
+  if (type == BarcodeType::EAN2) {
+    // EAN-2 uses the value modulo 4
+    int value = (addOnText[0] - '0') * 10 + (addOnText[1] - '0');
+    return value % 4;
+  }
+  else if (type == BarcodeType::EAN5) {
+    // EAN-5 weights digits alternately by 3 and 9, starting with 3
+    int sum = 0;
+    for (int i = 0; i < 5; i++) {
+      int digit = addOnText[i] - '0';
+      sum += (i % 2 == 0) ? 3 * digit : 9 * digit;
+    }
+    return sum % 10;
+  }
+
+  return 0;
+}
+
 /////////////////////////////////////////////////
 // getNumberOfDigits method
 /////////////////////////////////////////////////
@@ -113,6 +174,10 @@ uint16_t BarcodeChecker::getNumberOfDigits(BarcodeType type) {
       return 12;
     case BarcodeType::UPCE:
       return 8;
+    case BarcodeType::EAN2:
+      return 2;
+    case BarcodeType::EAN5:
+      return 5;
     case BarcodeType::Unknown:
       return 0;
   }
@@ -200,6 +265,20 @@ bool BarcodeChecker::validateChecksum(const char *barcodeText, BarcodeType type)
   return checksum == lastDigit;
 }
 
+/////////////////////////////////////////////////
+// hasOnlyDigits method
+/////////////////////////////////////////////////
+
+bool BarcodeChecker::hasOnlyDigits(const char *barcodeText, int textLength) {
+  for (int i = 0; i < textLength; i++) {
+    int digit = barcodeText[i] - '0';
+    if (digit < 0 || digit > 9) {
+      return false;
+    }
+  }
+  return true;
+}
+
 /////////////////////////////////////////////////
 // uint64ToStr method
 /////////////////////////////////////////////////
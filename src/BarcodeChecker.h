@@ -1,3 +1,5 @@
+#pragma once
+
 #include <Arduino.h>
 
 
@@ -6,7 +8,9 @@ enum class BarcodeType {
   EAN13,
   EAN8,
   UPCA,
-  UPCE
+  UPCE,
+  EAN2,  // 2-digit add-on supplement (periodicals issue number)
+  EAN5   // 5-digit add-on supplement (book price, weighted goods)
 };
 
 
@@ -23,6 +27,17 @@ public:
   static BarcodeType detectType(const String &barcodeText, bool padWithLeadingZeros = true);
   static BarcodeType detectType(uint64_t barcodeNumber,    bool padWithLeadingZeros = true);
 
+  // detects EAN-2 or EAN-5 add-on supplements
+  // detectType never returns these types, since an add-on is not a valid barcode on its own
+  static BarcodeType detectAddOnType(const char *addOnText,   bool padWithLeadingZeros = true);
+  static BarcodeType detectAddOnType(const String &addOnText, bool padWithLeadingZeros = true);
+
+  static bool isAddOn(BarcodeType type);
+
+  // add-ons have no check digit, their checksum is encoded in the L/G parity of the digits
+  // returns 0-3 for EAN-2 and 0-9 for EAN-5 (addOnText must have the exact number of digits)
+  static uint8_t getAddOnChecksum(const char *addOnText, BarcodeType type);
+
   static uint16_t getNumberOfDigits(BarcodeType type);
 
   static void padWithLeadingZeros(char *newBarcodeText, const char *barcodeText, BarcodeType type);
@@ -35,6 +50,8 @@ private:
   static void padWithLeadingZeros(char *newBarcodeText, const char *barcodeText, int finalLength);
 
   static bool validateChecksum(const char *barcodeText, BarcodeType type);
+
+  static bool hasOnlyDigits(const char *barcodeText, int textLength);
 };
 
 
@@ -26,12 +26,16 @@ static constexpr char UPCE_ONE_PATTERN[10][7] = {
   "LLLGGG", "LLGLGG", "LLGGLG", "LLGGGL", "LGLLGG", "LGGLLG", "LGGGLL", "LGLGLG", "LGLGGL", "LGGLGL"
 };
 
-static constexpr int PADDING = 5;
-static constexpr int DIGIT_PADDING_TOP = 3;
-static constexpr int MAX_BARCODE_LENGTH = 20; // max digits in a 64 bit number
+// Add-on encoding pattern according to the add-on checksum (determines the L and G combination)
+static constexpr char EAN2_PATTERN[4][3] = {
+  "LL", "LG", "GL", "GG"
+};
 
+static constexpr char EAN5_PATTERN[10][6] = {
+  "GGLLL", "GLGLL", "GLLGL", "GLLLG", "LGGLL", "LLGGL", "LLLGG", "LGLGL", "LGLLG", "LLGLG"
+};
 
-void uint64ToStr(uint64_t number, char *text);
+static constexpr int MAX_BARCODE_LENGTH = 20; // max digits in a 64 bit number
 
 
 BarcodeGFX::BarcodeGFX(Adafruit_GFX& _display)
@@ -56,7 +60,21 @@ bool BarcodeGFX::draw(uint64_t codeNumber, int16_t x, int16_t y, uint16_t height
 }
 
 bool BarcodeGFX::draw(const char *codeText, int16_t x, int16_t y, uint16_t height,
+                      BarcodeType type) const {
+  return draw(codeText, nullptr, x, y, height, type);
+}
+
+bool BarcodeGFX::draw(const String &codeText, const String &addOnText, int16_t x, int16_t y, uint16_t height,
+                      BarcodeType type) const {
+  return draw(codeText.c_str(), addOnText.c_str(), x, y, height, type);
+}
+
+bool BarcodeGFX::draw(const char *codeText, const char *addOnText, int16_t x, int16_t y, uint16_t height,
                       BarcodeType barcodeType) const {
+  if (BarcodeChecker::isAddOn(barcodeType)) {
+    return false;
+  }
+
   if (barcodeType == BarcodeType::Unknown) {
     barcodeType = BarcodeChecker::detectType(codeText, padWithLeadingZeros);
     if (barcodeType == BarcodeType::Unknown) {
@@ -64,8 +82,48 @@ bool BarcodeGFX::draw(const char *codeText, int16_t x, int16_t y, uint16_t heigh
     }
   }
 
+  // Add-on is optional, but must be valid if given
+  BarcodeType addOnType = BarcodeType::Unknown;
+  if (addOnText != nullptr) {
+    addOnType = BarcodeChecker::detectAddOnType(addOnText, padWithLeadingZeros);
+    if (addOnType == BarcodeType::Unknown) {
+      return false;
+    }
+  }
+
+  return draw(codeText, addOnText, x, y, getLayout(barcodeType, height, addOnType));
+}
+
+bool BarcodeGFX::draw(const String &codeText, int16_t x, int16_t y, const BarcodeLayout &layout) const {
+  return draw(codeText.c_str(), x, y, layout);
+}
+
+bool BarcodeGFX::draw(uint64_t codeNumber, int16_t x, int16_t y, const BarcodeLayout &layout) const {
+  char codeText[MAX_BARCODE_LENGTH + 1];
+  BarcodeHelper::uint64ToStr(codeNumber, codeText);
+
+  return draw(codeText, x, y, layout);
+}
+
+bool BarcodeGFX::draw(const char *codeText, int16_t x, int16_t y, const BarcodeLayout &layout) const {
+  return draw(codeText, nullptr, x, y, layout);
+}
+
+bool BarcodeGFX::draw(const String &codeText, const String &addOnText, int16_t x, int16_t y,
+                      const BarcodeLayout &layout) const {
+  return draw(codeText.c_str(), addOnText.c_str(), x, y, layout);
+}
+
+bool BarcodeGFX::draw(const char *codeText, const char *addOnText, int16_t x, int16_t y,
+                      const BarcodeLayout &layout) const {
+  if (!layout.isValid()) {
+    return false;
+  }
+  BarcodeType barcodeType = layout.type;
+  BarcodeType addOnType = layout.addOnType;
+
+  char newCodeText[MAX_BARCODE_LENGTH + 1];
   if (padWithLeadingZeros) {
-    char newCodeText[MAX_BARCODE_LENGTH + 1];
     BarcodeChecker::padWithLeadingZeros(newCodeText, codeText, barcodeType);
     codeText = newCodeText;
   }
@@ -73,128 +131,161 @@ bool BarcodeGFX::draw(const char *codeText, int16_t x, int16_t y, uint16_t heigh
   if (!BarcodeChecker::isValid(codeText, barcodeType, false)) {
     return false;
   }
-  
-  int width = getWidth(barcodeType);
-
-  display.fillRect(x, y, width, height, backgroundColor);
 
-  // Adjust drawing parameters
-  int padding = PADDING * scale;
-  int barY = y + padding;
-  int digitHeight = getDigitHeight();
-  int numberY = y + height - padding - digitHeight;
-  int barHeight = numberY - barY - DIGIT_PADDING_TOP * scale;
-  int longBarHeight = barHeight + DIGIT_PADDING_TOP * scale + digitHeight/2;
-  if (!showDigits) {
-    barHeight += DIGIT_PADDING_TOP * scale;
-    longBarHeight = barHeight;
+  // Add-on text must match the layout add-on type
+  char newAddOnText[MAX_BARCODE_LENGTH + 1];
+  if ((addOnText != nullptr) != (addOnType != BarcodeType::Unknown)) {
+    return false;
+  }
+  if (addOnText != nullptr) {
+    if (padWithLeadingZeros) {
+      BarcodeChecker::padWithLeadingZeros(newAddOnText, addOnText, addOnType);
+      addOnText = newAddOnText;
+    }
+    if (!BarcodeChecker::isValid(addOnText, addOnType, false)) {
+      return false;
+    }
   }
-  int numberWidth = getDigitWidth();
-
-  int16_t currentX = x + padding;
-  y += padding;
 
-  int index1, index2, index3;
+  // EAN-13 uses a L/G pattern according to the first digit
+  // UPC-E uses a L/G pattern according to the first and the last digit
+  int firstDigit = codeText[0] - '0';
+  const char *leftPattern = nullptr;
   if (barcodeType == BarcodeType::EAN13) {
-    index1 = 1; index2 = 7; index3 = 13;
-  }
-  else if (barcodeType == BarcodeType::EAN8) {
-    index1 = 0; index2 = 4; index3 = 8;
-  }
-  else if (barcodeType == BarcodeType::UPCA) {
-    index1 = 1; index2 = 6; index3 = 11;
+    leftPattern = EAN13_PATTERN[firstDigit];
   }
   else if (barcodeType == BarcodeType::UPCE) {
-    index1 = 1; index2 = 7; index3 = 7;
+    int lastDigit = codeText[7] - '0';
+    leftPattern = (firstDigit == 0) ? UPCE_ZERO_PATTERN[lastDigit] : UPCE_ONE_PATTERN[lastDigit];
   }
 
-  // Draw first digit outside (except for EAN-8)
-  if (barcodeType != BarcodeType::EAN8 && showDigits) {
-    drawDigit(codeText[0], currentX, numberY);
-    currentX += numberWidth;
+  // Add-on uses a L/G pattern according to its checksum
+  const char *addOnPattern = nullptr;
+  if (addOnType != BarcodeType::Unknown) {
+    uint8_t checksum = BarcodeChecker::getAddOnChecksum(addOnText, addOnType);
+    addOnPattern = (addOnType == BarcodeType::EAN5) ? EAN5_PATTERN[checksum] : EAN2_PATTERN[checksum];
   }
 
-  // Draw start guard pattern
-  drawPattern("101", currentX, y, longBarHeight);
-  currentX += 3 * scale;
+  // Background covers the barcode and the add-on in a single fill
+  display.fillRect(x, y, layout.width, layout.height, backgroundColor);
+
+  // Digit symbols are stored in text order, so their index is counted while walking the list
+  // left and right sides start at the second digit, except for EAN-8
+  uint8_t firstBarDigitIndex = (barcodeType == BarcodeType::EAN8) ? 0 : 1;
+  uint8_t lastDigitIndex = BarcodeChecker::getNumberOfDigits(barcodeType) - 1;
+  uint8_t digitIndex = firstBarDigitIndex;
+  uint8_t addOnDigitIndex = 0;
+
+  // All bars are sent in a single write transaction
+  int16_t barY = y + layout.barY;
+  int16_t addOnBarY = y + layout.addOnBarY;
+  uint16_t moduleWidth = layout.scale;
+  display.startWrite();
+  for (uint8_t i = 0; i < layout.numberOfSymbols; i++) {
+    const BarcodeLayout::Symbol &symbol = layout.symbols[i];
+    int16_t symbolX = x + symbol.x;
+    int digit;
+    const char *digitPattern;
 
-  // UPC-A draws long bars for first digit after start guard
-  int firstDigit = codeText[0] - '0';
-  if (barcodeType == BarcodeType::UPCA) {
-    drawPattern(EAN_L[firstDigit], currentX, y, longBarHeight);
-    currentX += 7 * scale;
+    switch (symbol.kind) {
+      case BarcodeLayout::SymbolKind::StartGuard:
+      case BarcodeLayout::SymbolKind::EndGuard:
+        drawPattern("101", symbolX, barY, layout.longBarHeight, moduleWidth);
+        break;
+      case BarcodeLayout::SymbolKind::MiddleGuard:
+        drawPattern("01010", symbolX, barY, layout.longBarHeight, moduleWidth);
+        break;
+      case BarcodeLayout::SymbolKind::UPCEEndGuard:
+        drawPattern("010101", symbolX, barY, layout.longBarHeight, moduleWidth);
+        break;
+      case BarcodeLayout::SymbolKind::LeftDigit:
+        digit = codeText[digitIndex] - '0';
+        if (leftPattern != nullptr && leftPattern[digitIndex - 1] == 'G') {
+          digitPattern = EAN_G[digit];
+        }
+        else {
+          digitPattern = EAN_L[digit];
+        }
+        drawPattern(digitPattern, symbolX, barY, layout.barHeight, moduleWidth);
+        digitIndex++;
+        break;
+      case BarcodeLayout::SymbolKind::RightDigit:
+        digit = codeText[digitIndex] - '0';
+        drawPattern(EAN_R[digit], symbolX, barY, layout.barHeight, moduleWidth);
+        digitIndex++;
+        break;
+      case BarcodeLayout::SymbolKind::LongLeftDigit:
+        digit = codeText[0] - '0';
+        drawPattern(EAN_L[digit], symbolX, barY, layout.longBarHeight, moduleWidth);
+        break;
+      case BarcodeLayout::SymbolKind::LongRightDigit:
+        digit = codeText[lastDigitIndex] - '0';
+        drawPattern(EAN_R[digit], symbolX, barY, layout.longBarHeight, moduleWidth);
+        break;
+      case BarcodeLayout::SymbolKind::AddOnStartGuard:
+        drawPattern("1011", symbolX, addOnBarY, layout.addOnBarHeight, moduleWidth);
+        break;
+      case BarcodeLayout::SymbolKind::AddOnSeparator:
+        drawPattern("01", symbolX, addOnBarY, layout.addOnBarHeight, moduleWidth);
+        break;
+      case BarcodeLayout::SymbolKind::AddOnDigit:
+        digit = addOnText[addOnDigitIndex] - '0';
+        digitPattern = (addOnPattern[addOnDigitIndex] == 'G') ? EAN_G[digit] : EAN_L[digit];
+        drawPattern(digitPattern, symbolX, addOnBarY, layout.addOnBarHeight, moduleWidth);
+        addOnDigitIndex++;
+        break;
+      case BarcodeLayout::SymbolKind::FirstTextDigit:
+      case BarcodeLayout::SymbolKind::LastTextDigit:
+        break;
+    }
   }
+  display.endWrite();
 
-  // Draw left side
-  for (int i = index1; i < index2; i++) {
-    int digit = codeText[i] - '0';
-    // EAN-13 uses a L/G pattern according to the first digit
-    const char *digitPattern;
-    if (barcodeType == BarcodeType::EAN13) {
-      const char *pattern = EAN13_PATTERN[firstDigit];
-      if (pattern[i - 1] == 'G') {
-        digitPattern = EAN_G[digit];
-      }
-      else {
-        digitPattern = EAN_L[digit];
-      }
-    }
-    // UPC-E uses a L/G pattern according to the first and the last digit
-    else if (barcodeType == BarcodeType::UPCE) {
-      int lastDigit = codeText[7] - '0';
-      const char *pattern = (firstDigit == 0) ? UPCE_ZERO_PATTERN[lastDigit] : UPCE_ONE_PATTERN[lastDigit];
-      if (pattern[i - 1] == 'G') {
-        digitPattern = EAN_G[digit];
-      }
-      else {
-        digitPattern = EAN_L[digit];
+  // Draw digits
+  if (layout.showDigits) {
+    display.setTextSize(layout.scale);
+    display.setTextColor(barColor);
+    display.setTextWrap(false);
+    digitIndex = firstBarDigitIndex;
+    addOnDigitIndex = 0;
+    for (uint8_t i = 0; i < layout.numberOfSymbols; i++) {
+      const BarcodeLayout::Symbol &symbol = layout.symbols[i];
+      int16_t digitX = x + layout.getDigitX(symbol);
+      switch (symbol.kind) {
+        case BarcodeLayout::SymbolKind::LeftDigit:
+        case BarcodeLayout::SymbolKind::RightDigit:
+          display.setCursor(digitX, y + layout.digitY);
+          display.print(codeText[digitIndex++]);
+          break;
+        case BarcodeLayout::SymbolKind::FirstTextDigit:
+          display.setCursor(digitX, y + layout.digitY);
+          display.print(codeText[0]);
+          break;
+        case BarcodeLayout::SymbolKind::LastTextDigit:
+          display.setCursor(digitX, y + layout.digitY);
+          display.print(codeText[lastDigitIndex]);
+          break;
+        case BarcodeLayout::SymbolKind::AddOnDigit:
+          display.setCursor(digitX, y + layout.addOnDigitY);
+          display.print(addOnText[addOnDigitIndex++]);
+          break;
+        default:
+          break;
       }
     }
-    else {
-      digitPattern = EAN_L[digit];
-    }
-    drawPattern(digitPattern, currentX, y, barHeight);
-    drawDigit(codeText[i], currentX + scale * 1.5, numberY);
-    currentX += 7 * scale;
-  }
-
-  // Draw middle guard pattern
-  if (barcodeType != BarcodeType::UPCE) {
-    drawPattern("01010", currentX, y, longBarHeight);
-    currentX += 5 * scale;
-  }
-
-  // Draw right side
-  for (int i = index2; i < index3; i++) {
-    int digit = codeText[i] - '0';
-    drawPattern(EAN_R[digit], currentX, y, barHeight);
-    drawDigit(codeText[i], currentX + scale * 0.5, numberY);
-    currentX += 7 * scale;
   }
 
-  // UPC-A draws long bars for last digit before end guard
-  if (barcodeType == BarcodeType::UPCA) {
-    int lastDigit = codeText[11] - '0';
-    drawPattern(EAN_R[lastDigit], currentX, y, longBarHeight);
-    currentX += 7 * scale;
-  }
+  return true;  
+}
 
-  // Draw end guard pattern
-  if (barcodeType == BarcodeType::UPCE) {
-    drawPattern("010101", currentX, y, longBarHeight);
-    currentX += 6 * scale;
-  }
-  else {
-    drawPattern("101", currentX, y, longBarHeight);
-    currentX += 3 * scale;  
-  }
-  
-  // Draw last digit
-  if (barcodeType == BarcodeType::UPCA || barcodeType == BarcodeType::UPCE) {
-    drawDigit(codeText[index3], currentX + scale, numberY);
-  }
+/////////////////////////////////////////////////
+// getLayout method
+/////////////////////////////////////////////////
 
-  return true;  
+BarcodeLayout BarcodeGFX::getLayout(BarcodeType type, uint16_t height, BarcodeType addOnType) const {
+  uint16_t digitWidth, digitHeight;
+  getDigitSize(digitWidth, digitHeight);
+  return BarcodeLayout(type, addOnType, height, scale, showDigits, digitWidth, digitHeight);
 }
 
 /////////////////////////////////////////////////
@@ -263,7 +354,7 @@ uint16_t BarcodeGFX::getWidth(const String &codeText) const {
 
 uint16_t BarcodeGFX::getWidth(uint64_t codeNumber) const {
   char codeText[MAX_BARCODE_LENGTH + 1];
-  uint64ToStr(codeNumber, codeText);
+  BarcodeHelper::uint64ToStr(codeNumber, codeText);
   return getWidth(codeText);
 }
 
@@ -272,54 +363,52 @@ uint16_t BarcodeGFX::getWidth(const char *codeText) const {
   return getWidth(type);
 }
 
-uint16_t BarcodeGFX::getWidth(BarcodeType type) const {
-  int digitWidth = getDigitWidth();
-
-  int padding = 2 * PADDING * scale;
-  int guardLength;
-  int barLength;
-
-  switch(type){
-    case BarcodeType::EAN8:
-      guardLength = (3 + 5 + 3) * scale;
-      barLength = 7 * 8 * scale;
-      break;
-    case BarcodeType::EAN13:
-      guardLength = (3 + 5 + 3) * scale;
-      barLength = 7 * 12 * scale;
-      if (showDigits) {
-        padding += digitWidth + scale;
-      }
-      break;
-    case BarcodeType::UPCA:
-      guardLength = (3 + 5 + 3) * scale;
-      barLength = 7 * 12 * scale;
-      if (showDigits) {
-        padding += 2 * (digitWidth + scale);
-      }
-      break;
-    case BarcodeType::UPCE:
-      guardLength = (3 + 0 + 6) * scale;
-      barLength = 7 * 6 * scale;
-      if (showDigits) {
-        padding += 2 * (digitWidth + scale);
-      }
-      break;
-    case BarcodeType::Unknown:
-      return 0;
+uint16_t BarcodeGFX::getWidth(const String &codeText, const String &addOnText) const {
+  return getWidth(codeText.c_str(), addOnText.c_str());
+}
+
+uint16_t BarcodeGFX::getWidth(const char *codeText, const char *addOnText) const {
+  BarcodeType type = BarcodeChecker::detectType(codeText);
+  if (addOnText == nullptr) {
+    return getWidth(type);
   }
-  return padding + guardLength + barLength;
+
+  // Invalid add-on can't be drawn, same as an invalid barcode
+  BarcodeType addOnType = BarcodeChecker::detectAddOnType(addOnText);
+  if (addOnType == BarcodeType::Unknown) {
+    return 0;
+  }
+  return getWidth(type, addOnType);
+}
+
+uint16_t BarcodeGFX::getWidth(BarcodeType type) const {
+  return getWidth(type, BarcodeType::Unknown);
+}
+
+uint16_t BarcodeGFX::getWidth(BarcodeType type, BarcodeType addOnType) const {
+  uint16_t digitWidth, digitHeight;
+  getDigitSize(digitWidth, digitHeight);
+  return BarcodeLayout::computeWidth(type, addOnType, scale, showDigits, digitWidth);
 }
 
 /////////////////////////////////////////////////
 // Private methods
 /////////////////////////////////////////////////
 
-void BarcodeGFX::drawPattern(const char *pattern, int16_t x, int16_t y, int16_t barHeight) const {
-  for (int i = 0; pattern[i] != '\0'; ++i) {
-    if (pattern[i] == '1') {
-      display.fillRect(x + i * scale, y, scale, barHeight, barColor);
+void BarcodeGFX::drawPattern(const char *pattern, int16_t x, int16_t y, int16_t barHeight, uint16_t moduleWidth) const {
+  // Adjacent modules are merged, so each bar is a single rect
+  // must be called between display.startWrite() and display.endWrite()
+  int i = 0;
+  while (pattern[i] != '\0') {
+    if (pattern[i] != '1') {
+      i++;
+      continue;
+    }
+    int start = i;
+    while (pattern[i] == '1') {
+      i++;
     }
+    display.writeFillRect(x + start * moduleWidth, y, (i - start) * moduleWidth, barHeight, barColor);
   }
 }
 
@@ -332,26 +421,4 @@ void BarcodeGFX::getDigitSize(uint16_t& width, uint16_t& height) const {
   int16_t x, y;
   display.setTextSize(scale);
   display.getTextBounds("0", 0, 0, &x, &y, &width, &height);
-}
-
-uint16_t BarcodeGFX::getDigitWidth() const {
-  uint16_t width, height;
-  getDigitSize(width, height);
-  return width;
-}
-
-uint16_t BarcodeGFX::getDigitHeight() const {
-  uint16_t width, height;
-  getDigitSize(width, height);
-  return height;
-}
-
-void BarcodeGFX::drawDigit(char digit, int16_t x, int16_t y) const {
-  if (showDigits) {
-    display.setTextSize(scale);
-    display.setTextColor(barColor);
-    display.setCursor(x, y);
-    display.setTextWrap(false);
-    display.print(digit);  
-  }
 }
\ No newline at end of file
@@ -1,6 +1,9 @@
+#pragma once
+
 #include <Arduino.h>
 #include <Adafruit_GFX.h>
 #include "BarcodeChecker.h"
+#include "BarcodeLayout.h"
 
 class BarcodeGFX {
 public:
@@ -16,6 +19,27 @@ public:
   bool draw(const String &codeText, int16_t x, int16_t y, uint16_t height, BarcodeType type = BarcodeType::Unknown) const;
   bool draw(uint64_t codeNumber,    int16_t x, int16_t y, uint16_t height, BarcodeType type = BarcodeType::Unknown) const;
 
+  // draws the barcode followed by an EAN-2 or EAN-5 add-on supplement
+  // add-on type is detected from addOnText length (padded with leading zeros if enabled)
+  // returns false and doesn't draw if either the barcode or the add-on is invalid
+  // or if height is too short to fit the add-on bars below its digits
+  bool draw(const char *codeText,   const char *addOnText,   int16_t x, int16_t y, uint16_t height, BarcodeType type = BarcodeType::Unknown) const;
+  bool draw(const String &codeText, const String &addOnText, int16_t x, int16_t y, uint16_t height, BarcodeType type = BarcodeType::Unknown) const;
+
+  // draws using a precomputed layout (see getLayout), type is taken from the layout
+  // colors and padWithLeadingZeros are still read from this object
+  // returns false and doesn't draw if the text is not valid for the layout type
+  bool draw(const char *codeText,   int16_t x, int16_t y, const BarcodeLayout &layout) const;
+  bool draw(const String &codeText, int16_t x, int16_t y, const BarcodeLayout &layout) const;
+  bool draw(uint64_t codeNumber,    int16_t x, int16_t y, const BarcodeLayout &layout) const;
+  bool draw(const char *codeText,   const char *addOnText,   int16_t x, int16_t y, const BarcodeLayout &layout) const;
+  bool draw(const String &codeText, const String &addOnText, int16_t x, int16_t y, const BarcodeLayout &layout) const;
+
+  // computes the position of every bar and digit for the current scale, showDigits and display font
+  // reuse it to draw many barcodes of the same type and size without recomputing the geometry
+  // draw methods that take a height build a temporary layout (about 110 bytes of stack on AVR) on every call
+  BarcodeLayout getLayout(BarcodeType type, uint16_t height, BarcodeType addOnType = BarcodeType::Unknown) const;
+
   // Setters / getters for personalized drawing
   BarcodeGFX& setScale(uint16_t _scale);
   uint16_t getScale() const;
@@ -40,6 +64,11 @@ public:
   uint16_t getWidth(uint64_t codeNumber) const;
   uint16_t getWidth(BarcodeType type) const;
 
+  // width including an add-on supplement and the gap before it
+  uint16_t getWidth(const char *codeText,   const char *addOnText) const;
+  uint16_t getWidth(const String &codeText, const String &addOnText) const;
+  uint16_t getWidth(BarcodeType type, BarcodeType addOnType) const;
+
 
 private:
   Adafruit_GFX& display;
@@ -49,11 +78,7 @@ private:
   uint16_t barColor = 0x0000;
   bool padWithLeadingZeros = true;
 
-  void drawPattern(const char *pattern, int16_t x, int16_t y, int16_t barHeight) const;
+  void drawPattern(const char *pattern, int16_t x, int16_t y, int16_t barHeight, uint16_t moduleWidth) const;
 
   void getDigitSize(uint16_t& width, uint16_t& height) const;
-  uint16_t getDigitWidth() const;
-  uint16_t getDigitHeight() const;
-
-  void drawDigit(char digit, int16_t x, int16_t y) const;
 };
\ No newline at end of file
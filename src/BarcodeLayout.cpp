@@ -0,0 +1,249 @@
+#include "BarcodeLayout.h"
+
+static constexpr int PADDING = 5;
+static constexpr int ADD_ON_GAP = 9; // modules between the barcode and the add-on (7-12 for EAN, 9-12 for UPC)
+static constexpr int DIGIT_PADDING_TOP = 3;
+
+
+BarcodeLayout::BarcodeLayout() {
+}
+
+BarcodeLayout::BarcodeLayout(BarcodeType _type, BarcodeType _addOnType, uint16_t _height, uint16_t _scale,
+                             bool _showDigits, uint16_t digitWidth, uint16_t digitHeight) {
+  width = computeWidth(_type, _addOnType, _scale, _showDigits, digitWidth);
+  if (width == 0) {
+    return;
+  }
+
+  type = _type;
+  addOnType = _addOnType;
+  height = _height;
+  scale = _scale;
+  showDigits = _showDigits;
+  if (!showDigits) {
+    digitWidth = 0;
+    digitHeight = 0;
+  }
+
+  // Vertical positions
+  int padding = PADDING * scale;
+  barY = padding;
+  digitY = height - padding - digitHeight;
+  barHeight = digitY - barY - DIGIT_PADDING_TOP * scale;
+  longBarHeight = barHeight + DIGIT_PADDING_TOP * scale + digitHeight / 2;
+  if (!showDigits) {
+    barHeight += DIGIT_PADDING_TOP * scale;
+    longBarHeight = barHeight;
+  }
+
+  // Add-on digits are drawn above the bars, which are aligned with the bottom of the guard bars
+  addOnDigitY = barY;
+  addOnBarY = barY;
+  if (showDigits) {
+    addOnBarY += digitHeight + DIGIT_PADDING_TOP * scale;
+  }
+  addOnBarHeight = barY + longBarHeight - addOnBarY;
+  addOnDigitX = (7 * scale - digitWidth) / 2;
+  if (addOnType != BarcodeType::Unknown && addOnBarHeight <= 0) {
+    // too short for the add-on bars below its digits
+    type = BarcodeType::Unknown;
+    addOnType = BarcodeType::Unknown;
+    width = 0;
+    return;
+  }
+
+  // Digit index ranges for left and right sides
+  int index1, index2, index3;
+  if (type == BarcodeType::EAN13) {
+    index1 = 1; index2 = 7; index3 = 13;
+  }
+  else if (type == BarcodeType::EAN8) {
+    index1 = 0; index2 = 4; index3 = 8;
+  }
+  else if (type == BarcodeType::UPCA) {
+    index1 = 1; index2 = 6; index3 = 11;
+  }
+  else {
+    index1 = 1; index2 = 7; index3 = 7;
+  }
+
+  int16_t currentX = padding;
+
+  // First digit outside (except for EAN-8)
+  if (type != BarcodeType::EAN8 && showDigits) {
+    addSymbol(SymbolKind::FirstTextDigit, currentX);
+    currentX += digitWidth;
+  }
+
+  addSymbol(SymbolKind::StartGuard, currentX);
+  currentX += 3 * scale;
+
+  // UPC-A draws long bars for first digit after start guard
+  if (type == BarcodeType::UPCA) {
+    addSymbol(SymbolKind::LongLeftDigit, currentX);
+    currentX += 7 * scale;
+  }
+
+  for (int i = index1; i < index2; i++) {
+    addSymbol(SymbolKind::LeftDigit, currentX);
+    currentX += 7 * scale;
+  }
+
+  if (type != BarcodeType::UPCE) {
+    addSymbol(SymbolKind::MiddleGuard, currentX);
+    currentX += 5 * scale;
+  }
+
+  for (int i = index2; i < index3; i++) {
+    addSymbol(SymbolKind::RightDigit, currentX);
+    currentX += 7 * scale;
+  }
+
+  // UPC-A draws long bars for last digit before end guard
+  if (type == BarcodeType::UPCA) {
+    addSymbol(SymbolKind::LongRightDigit, currentX);
+    currentX += 7 * scale;
+  }
+
+  if (type == BarcodeType::UPCE) {
+    addSymbol(SymbolKind::UPCEEndGuard, currentX);
+    currentX += 6 * scale;
+  }
+  else {
+    addSymbol(SymbolKind::EndGuard, currentX);
+    currentX += 3 * scale;
+  }
+
+  // Last digit outside (UPC-A and UPC-E only)
+  int lastDigitWidth = 0;
+  if ((type == BarcodeType::UPCA || type == BarcodeType::UPCE) && showDigits) {
+    addSymbol(SymbolKind::LastTextDigit, currentX + scale);
+    lastDigitWidth = scale + digitWidth;
+  }
+
+  // Add-on gap is measured from the end guard, the last digit sits inside it
+  // Add-on has a start guard and a separator between digits, each digit is centered above its bars
+  if (addOnType != BarcodeType::Unknown) {
+    int gap = ADD_ON_GAP * scale;
+    currentX += (lastDigitWidth > gap) ? lastDigitWidth : gap;
+    addSymbol(SymbolKind::AddOnStartGuard, currentX);
+    currentX += 4 * scale;
+
+    int addOnDigits = BarcodeChecker::getNumberOfDigits(addOnType);
+    for (int i = 0; i < addOnDigits; i++) {
+      if (i > 0) {
+        addSymbol(SymbolKind::AddOnSeparator, currentX);
+        currentX += 2 * scale;
+      }
+      addSymbol(SymbolKind::AddOnDigit, currentX);
+      currentX += 7 * scale;
+    }
+  }
+}
+
+uint16_t BarcodeLayout::computeWidth(BarcodeType type, BarcodeType addOnType, uint16_t scale,
+                                     bool showDigits, uint16_t digitWidth) {
+  if (type == BarcodeType::Unknown || BarcodeChecker::isAddOn(type)) {
+    return 0;
+  }
+  if (addOnType != BarcodeType::Unknown && !BarcodeChecker::isAddOn(addOnType)) {
+    return 0;
+  }
+
+  // Guards and bars
+  int modules;
+  if (type == BarcodeType::EAN8) {
+    modules = 3 + 7 * 8 + 5 + 3;
+  }
+  else if (type == BarcodeType::UPCE) {
+    modules = 3 + 7 * 6 + 6;
+  }
+  else {
+    modules = 3 + 7 * 12 + 5 + 3;
+  }
+  int width = 2 * PADDING * scale + modules * scale;
+
+  // Digits outside the bars, one extra module is reserved for each
+  int lastDigitWidth = 0;
+  if (showDigits) {
+    if (type != BarcodeType::EAN8) {
+      width += digitWidth + scale;
+    }
+    if (type == BarcodeType::UPCA || type == BarcodeType::UPCE) {
+      lastDigitWidth = digitWidth + scale;
+    }
+  }
+
+  // Add-on gap is measured from the end guard, the last digit sits inside it
+  // Add-on has a start guard (4 modules) and a separator (2 modules) between digits
+  if (addOnType != BarcodeType::Unknown) {
+    int gap = ADD_ON_GAP * scale;
+    int addOnDigits = BarcodeChecker::getNumberOfDigits(addOnType);
+    width += (lastDigitWidth > gap) ? lastDigitWidth : gap;
+    width += (4 + 7 * addOnDigits + 2 * (addOnDigits - 1)) * scale;
+  }
+  else {
+    width += lastDigitWidth;
+  }
+
+  return width;
+}
+
+/////////////////////////////////////////////////
+// Getters
+/////////////////////////////////////////////////
+
+bool BarcodeLayout::isValid() const {
+  return type != BarcodeType::Unknown;
+}
+
+BarcodeType BarcodeLayout::getType() const {
+  return type;
+}
+
+BarcodeType BarcodeLayout::getAddOnType() const {
+  return addOnType;
+}
+
+uint16_t BarcodeLayout::getScale() const {
+  return scale;
+}
+
+bool BarcodeLayout::getShowDigits() const {
+  return showDigits;
+}
+
+uint16_t BarcodeLayout::getWidth() const {
+  return width;
+}
+
+uint16_t BarcodeLayout::getHeight() const {
+  return height;
+}
+
+/////////////////////////////////////////////////
+// Private methods
+/////////////////////////////////////////////////
+
+void BarcodeLayout::addSymbol(SymbolKind kind, int16_t x) {
+  if (numberOfSymbols >= MAX_SYMBOLS) {
+    return;
+  }
+  Symbol &symbol = symbols[numberOfSymbols++];
+  symbol.kind = kind;
+  symbol.x = x;
+}
+
+int16_t BarcodeLayout::getDigitX(const Symbol &symbol) const {
+  // Left side digits are shifted 1.5 modules, right side 0.5 module
+  switch (symbol.kind) {
+    case SymbolKind::LeftDigit:
+      return symbol.x + 3 * scale / 2;
+    case SymbolKind::RightDigit:
+      return symbol.x + scale / 2;
+    case SymbolKind::AddOnDigit:
+      return symbol.x + addOnDigitX;
+    default:
+      return symbol.x;
+  }
+}
\ No newline at end of file
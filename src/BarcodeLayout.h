@@ -0,0 +1,90 @@
+#pragma once
+
+#include <Arduino.h>
+#include "BarcodeChecker.h"
+
+
+// Precomputed geometry of a barcode: position of every guard, bar and digit
+// it only depends on the barcode type, scale, height and digit font (not on the digits themselves)
+// so it can be computed once with BarcodeGFX::getLayout and reused for many draws and width queries
+// all coordinates are integer pixels relative to the upper left corner of the barcode
+// a layout takes about 110 bytes of RAM on AVR, keep one long-lived layout instead of many temporary ones
+class BarcodeLayout {
+public:
+  // empty layout, not valid for drawing
+  BarcodeLayout();
+
+  // digit size is ignored if showDigits is false
+  // addOnType must be EAN2, EAN5 or Unknown (no add-on)
+  BarcodeLayout(BarcodeType type, BarcodeType addOnType, uint16_t height, uint16_t scale,
+                bool showDigits, uint16_t digitWidth, uint16_t digitHeight);
+
+  // false if type is not a barcode type, addOnType is not an add-on type
+  // or height is too short to fit the add-on bars below its digits
+  bool isValid() const;
+
+  BarcodeType getType() const;
+  BarcodeType getAddOnType() const;
+  uint16_t getScale() const;
+  bool getShowDigits() const;
+
+  // this is usefull if you need to center the drawing on screen
+  // in that case, you can make x = (screenWidth - layout.getWidth()) / 2
+  uint16_t getWidth() const;
+  uint16_t getHeight() const;
+
+  // same as getWidth, without building a layout (returns 0 for invalid types)
+  static uint16_t computeWidth(BarcodeType type, BarcodeType addOnType, uint16_t scale,
+                               bool showDigits, uint16_t digitWidth);
+
+
+private:
+  friend class BarcodeGFX;
+
+  enum class SymbolKind : uint8_t {
+    StartGuard,       // long bars
+    MiddleGuard,
+    EndGuard,
+    UPCEEndGuard,
+    LeftDigit,        // short bars, L/G parity according to barcode type, digit below
+    RightDigit,       // short bars, R encoding, digit below
+    LongLeftDigit,    // UPC-A first digit: long bars, L encoding, no digit below
+    LongRightDigit,   // UPC-A last digit: long bars, R encoding, no digit below
+    FirstTextDigit,   // first digit drawn outside the bars
+    LastTextDigit,    // last digit drawn outside the bars
+    AddOnStartGuard,  // add-on bars
+    AddOnSeparator,
+    AddOnDigit        // add-on bars, L/G parity according to add-on checksum, digit above
+  };
+
+  // digit index and digit position are not stored, they follow from the kind and order of symbols
+  struct Symbol {
+    int16_t x;
+    SymbolKind kind;
+  };
+
+  // worst case is UPC-A (17 symbols with outside digits) with an EAN-5 add-on (10 symbols)
+  static constexpr uint8_t MAX_SYMBOLS = 27;
+
+  BarcodeType type = BarcodeType::Unknown;
+  BarcodeType addOnType = BarcodeType::Unknown;
+  uint16_t scale = 1;
+  bool showDigits = false;
+  uint16_t width = 0;
+  uint16_t height = 0;
+
+  int16_t barY = 0;
+  int16_t barHeight = 0;
+  int16_t longBarHeight = 0;
+  int16_t digitY = 0;
+  int16_t addOnBarY = 0;
+  int16_t addOnBarHeight = 0;
+  int16_t addOnDigitY = 0;
+  int16_t addOnDigitX = 0;  // offset from the add-on digit bars
+
+  Symbol symbols[MAX_SYMBOLS];
+  uint8_t numberOfSymbols = 0;
+
+  void addSymbol(SymbolKind kind, int16_t x);
+  int16_t getDigitX(const Symbol &symbol) const;
+};
\ No newline at end of file